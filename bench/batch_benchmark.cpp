@@ -0,0 +1,101 @@
+// Renders the same set of preview jobs with 1, 2, 4, ... workers and prints
+// throughput, to check that BatchRenderer scales with cores.
+//
+//   cmake -B build-bench -DTHEREMIN_BUILD_BENCHMARKS=ON
+//   cmake --build build-bench --target batch-benchmark
+//   ./build-bench/batch-benchmark
+
+#include "../native/batch.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+namespace {
+
+constexpr float sampleRate = 44100.0f;
+constexpr int numJobs = 64;
+constexpr size_t jobLength = 44100 * 4;
+
+// Pitch-swept decaying sine, roughly kick shaped
+std::shared_ptr<const std::vector<float>> makeKick()
+{
+  auto kick = std::make_shared<std::vector<float>>(8820);
+  double phase = 0.0;
+  for (size_t i = 0; i < kick->size(); ++i) {
+    double t = i / sampleRate;
+    double frequency = 50.0 + 150.0 * std::exp(-t * 30.0);
+    phase += 2.0 * 3.141592653589793 * frequency / sampleRate;
+    (*kick)[i] = static_cast<float>(std::sin(phase) * std::exp(-t * 8.0));
+  }
+  return kick;
+}
+
+// Stereo exponentially decaying noise
+std::shared_ptr<const AudioClip> makeIR(size_t length, unsigned seed)
+{
+  auto ir = std::make_shared<AudioClip>();
+  ir->numChannels = 2;
+  ir->samples.resize(length * 2);
+
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  for (size_t i = 0; i < length; ++i) {
+    float decay = std::exp(-6.0f * i / length);
+    ir->samples[i * 2] = dist(rng) * decay * 0.1f;
+    ir->samples[i * 2 + 1] = dist(rng) * decay * 0.1f;
+  }
+  return ir;
+}
+
+class NullSink : public RenderSink
+{
+public:
+  void write(const float*, const float*, int) override {}
+};
+
+} // namespace
+
+int main()
+{
+  auto kick = makeKick();
+  std::shared_ptr<const AudioClip> irs[] = { makeIR(44100, 1),
+                                             makeIR(66150, 2) };
+
+  std::vector<RenderJob> jobs(numJobs);
+  for (int i = 0; i < numJobs; ++i) {
+    jobs[i].sample = kick;
+    jobs[i].impulseResponse = irs[i % 2];
+    jobs[i].drive = 1.0f + (i % 8) * 2.5f;
+    jobs[i].ottAmount = (i % 5) * 0.25f;
+    jobs[i].reverbMix = 0.3f;
+    jobs[i].lengthSamples = jobLength;
+    jobs[i].output = std::make_shared<NullSink>();
+  }
+
+  int maxWorkers =
+    static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  double baseline = 0.0;
+
+  std::printf("%8s %12s %10s\n", "workers", "jobs/s", "speedup");
+
+  for (int workers = 1; workers <= maxWorkers; workers *= 2) {
+    BatchRenderer renderer(sampleRate, workers);
+
+    auto start = std::chrono::steady_clock::now();
+    renderer.render(jobs);
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double jobsPerSecond = numJobs / seconds;
+    if (workers == 1)
+      baseline = jobsPerSecond;
+
+    std::printf(
+      "%8d %12.2f %9.2fx\n", workers, jobsPerSecond, jobsPerSecond / baseline);
+  }
+
+  return 0;
+}
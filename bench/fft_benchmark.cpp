@@ -0,0 +1,138 @@
+// Checks that the split-radix backend matches JuceFFTBackend, then times one
+// forward + inverse real FFT for each backend across FFT sizes.
+// ConvolutionEngine runs one forward and one inverse 512-point transform per
+// 128-sample block (the block plus a 384-sample IR segment).
+//
+//   cmake -B build-bench -DTHEREMIN_BUILD_BENCHMARKS=ON
+//   cmake --build build-bench --target fft-benchmark
+//   ./build-bench/fft-benchmark
+
+#include "../dsp/fft.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static constexpr float maxAllowedError = 1e-5f;
+
+// Largest difference between the two backends' packed spectra, relative to
+// the spectrum's peak, and the split-radix round-trip error
+static bool checkAccuracy(int order)
+{
+  JuceFFTBackend juceFFT(order);
+  SplitRadixFFTBackend splitFFT(order);
+  size_t size = splitFFT.getSize();
+
+  std::mt19937 rng(order);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> input(size);
+  for (auto& sample : input)
+    sample = dist(rng);
+
+  std::vector<float> juceData(size * 2, 0.0f);
+  std::vector<float> splitData(size * 2, 0.0f);
+  std::copy(input.begin(), input.end(), juceData.begin());
+  std::copy(input.begin(), input.end(), splitData.begin());
+
+  juceFFT.forward(juceData.data());
+  splitFFT.forward(splitData.data());
+
+  float peak = 0.0f;
+  float spectrumError = 0.0f;
+  for (size_t i = 0; i <= size; ++i) {
+    peak = std::max(peak, std::abs(juceData[i]));
+    spectrumError =
+      std::max(spectrumError, std::abs(juceData[i] - splitData[i]));
+  }
+  spectrumError /= std::max(peak, 1e-20f);
+
+  splitFFT.inverse(splitData.data());
+
+  float roundTripError = 0.0f;
+  for (size_t i = 0; i < size; ++i)
+    roundTripError =
+      std::max(roundTripError, std::abs(splitData[i] - input[i]));
+
+  bool ok =
+    spectrumError <= maxAllowedError && roundTripError <= maxAllowedError;
+  if (!ok)
+    std::printf("order %d: spectrum error %g, round-trip error %g\n",
+                order,
+                spectrumError,
+                roundTripError);
+
+  return ok;
+}
+
+template<RealFFTBackend Backend>
+static double nanosecondsPerRoundTrip(int order, int iterations)
+{
+  Backend fft(order);
+  size_t size = fft.getSize();
+
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> input(size);
+  for (auto& sample : input)
+    sample = dist(rng);
+
+  std::vector<float> buffer(size * 2, 0.0f);
+  float sink = 0.0f;
+
+  auto run = [&](int count) {
+    for (int i = 0; i < count; ++i) {
+      std::copy(input.begin(), input.end(), buffer.begin());
+      fft.forward(buffer.data());
+      fft.inverse(buffer.data());
+      sink += buffer[i % size];
+    }
+  };
+
+  run(iterations / 10 + 1);
+
+  auto start = std::chrono::steady_clock::now();
+  run(iterations);
+  auto end = std::chrono::steady_clock::now();
+
+  if (sink == 12345.0f)
+    std::printf(" ");
+
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         iterations;
+}
+
+int main()
+{
+  bool accurate = true;
+  for (int order = 2; order <= 13; ++order)
+    accurate = checkAccuracy(order) && accurate;
+
+  if (!accurate) {
+    std::printf("split-radix backend does not match JUCE; not timing\n");
+    return 1;
+  }
+
+  std::printf("%10s %14s %14s %9s\n",
+              "fft size",
+              "juce (ns)",
+              "split (ns)",
+              "speedup");
+
+  for (int order = 7; order <= 13; ++order) {
+    int iterations = (1 << 22) >> order;
+    double juceNs = nanosecondsPerRoundTrip<JuceFFTBackend>(order, iterations);
+    double splitNs =
+      nanosecondsPerRoundTrip<SplitRadixFFTBackend>(order, iterations);
+
+    std::printf("%10d %14.1f %14.1f %8.2fx\n",
+                1 << order,
+                juceNs,
+                splitNs,
+                juceNs / splitNs);
+  }
+
+  return 0;
+}
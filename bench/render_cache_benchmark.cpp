@@ -0,0 +1,166 @@
+// Checks that a looping Sampler with the render cache produces the same
+// output as one without it, including across cache invalidations, then times
+// process() with and without the cache.
+//
+//   cmake -B build-bench -DTHEREMIN_BUILD_BENCHMARKS=ON
+//   cmake --build build-bench --target render-cache-benchmark
+//   ./build-bench/render-cache-benchmark
+
+#include "../dsp/sampler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static constexpr float sampleRate = 44100.0f;
+static constexpr float bpm = 140.0f;
+static constexpr int blockSize = 128;
+
+// The cache tolerates 1e-5 between periods; the OTT makeup gain can scale
+// that up by as much as 18 dB
+static constexpr float maxAllowedError = 1e-4f;
+
+// Pitch-swept decaying sine, roughly kick shaped
+static std::vector<float> makeKick()
+{
+  std::vector<float> kick(8820);
+  double phase = 0.0;
+  for (size_t i = 0; i < kick.size(); ++i) {
+    double t = i / sampleRate;
+    double frequency = 50.0 + 150.0 * std::exp(-t * 30.0);
+    phase += 2.0 * 3.141592653589793 * frequency / sampleRate;
+    kick[i] = static_cast<float>(std::sin(phase) * std::exp(-t * 8.0));
+  }
+  return kick;
+}
+
+static void setUp(Sampler& sampler, const std::vector<float>& kick,
+                  bool renderCache)
+{
+  sampler.prepare(sampleRate);
+  sampler.setBpm(bpm);
+  sampler.loadSample(reinterpret_cast<uintptr_t>(kick.data()), kick.size());
+  sampler.setWaveshaperDrive(6.0f);
+  sampler.setOTTAmount(0.7f);
+  sampler.setRenderCache(renderCache);
+  sampler.setLooping(true);
+}
+
+struct Change
+{
+  size_t position;
+  float drive;
+  float ottAmount;
+  bool retrigger;
+};
+
+// Both samplers receive each change at the same sample, mid-beat and while
+// the cached one is replaying, and must stay within maxAllowedError of each
+// other throughout. No impulse response is loaded; the reverb runs live in
+// both and is not under test.
+static bool checkAccuracy()
+{
+  std::vector<float> kick = makeKick();
+  Sampler cached, reference;
+  setUp(cached, kick, true);
+  setUp(reference, kick, false);
+
+  size_t samplesPerBeat = static_cast<size_t>(sampleRate / bpm * 60);
+  const Change changes[] = {
+    { samplesPerBeat * 6 + samplesPerBeat / 3, 9.0f, 0.7f, false },
+    { samplesPerBeat * 12 + samplesPerBeat / 2, 9.0f, 0.3f, false },
+    { samplesPerBeat * 18 + samplesPerBeat / 4, 9.0f, 0.3f, true },
+    { samplesPerBeat * 24 + 17, 2.0f, 1.0f, false },
+  };
+  size_t length = samplesPerBeat * 30;
+
+  std::vector<float> cachedL(blockSize), cachedR(blockSize);
+  std::vector<float> referenceL(blockSize), referenceR(blockSize);
+  float maxError = 0.0f;
+  size_t nextChange = 0;
+
+  for (size_t position = 0; position < length; position += blockSize) {
+    if (nextChange < std::size(changes) &&
+        changes[nextChange].position < position + blockSize) {
+      const Change& change = changes[nextChange++];
+      for (Sampler* sampler : { &cached, &reference }) {
+        sampler->setWaveshaperDrive(change.drive);
+        sampler->setOTTAmount(change.ottAmount);
+        if (change.retrigger)
+          sampler->trigger();
+      }
+    }
+
+    cached.process(reinterpret_cast<uintptr_t>(cachedL.data()),
+                   reinterpret_cast<uintptr_t>(cachedR.data()), blockSize);
+    reference.process(reinterpret_cast<uintptr_t>(referenceL.data()),
+                      reinterpret_cast<uintptr_t>(referenceR.data()),
+                      blockSize);
+
+    for (int i = 0; i < blockSize; ++i) {
+      maxError = std::max(maxError, std::abs(cachedL[i] - referenceL[i]));
+      maxError = std::max(maxError, std::abs(cachedR[i] - referenceR[i]));
+    }
+  }
+
+  bool accurate = maxError <= maxAllowedError;
+  std::printf("cached vs uncached: max error %.3g %s\n",
+              maxError,
+              accurate ? "" : "(FAIL)");
+  return accurate;
+}
+
+// Average process() time per 128-sample block over a looping 30 s render
+// with a 2 s stereo impulse response
+static double nanosecondsPerBlock(bool renderCache)
+{
+  std::vector<float> kick = makeKick();
+
+  size_t irLength = static_cast<size_t>(sampleRate * 2);
+  std::vector<float> ir(irLength * 2);
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  for (size_t i = 0; i < irLength; ++i) {
+    float decay = std::exp(-6.0f * i / irLength);
+    ir[i * 2] = dist(rng) * decay * 0.1f;
+    ir[i * 2 + 1] = dist(rng) * decay * 0.1f;
+  }
+
+  Sampler sampler;
+  setUp(sampler, kick, renderCache);
+  sampler.loadImpulseResponse(reinterpret_cast<uintptr_t>(ir.data()),
+                              irLength, 2);
+
+  std::vector<float> left(blockSize), right(blockSize);
+  int numBlocks = static_cast<int>(sampleRate * 30) / blockSize;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int block = 0; block < numBlocks; ++block)
+    sampler.process(reinterpret_cast<uintptr_t>(left.data()),
+                    reinterpret_cast<uintptr_t>(right.data()), blockSize);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  return std::chrono::duration<double, std::nano>(elapsed).count() / numBlocks;
+}
+
+int main()
+{
+  if (!checkAccuracy()) {
+    std::printf("render cache does not match the live chain; not timing\n");
+    return 1;
+  }
+
+  double uncachedNs = nanosecondsPerBlock(false);
+  double cachedNs = nanosecondsPerBlock(true);
+
+  std::printf("%14s %14s %9s\n", "uncached (ns)", "cached (ns)", "speedup");
+  std::printf("%14.1f %14.1f %8.2fx\n",
+              uncachedNs,
+              cachedNs,
+              uncachedNs / cachedNs);
+
+  return 0;
+}
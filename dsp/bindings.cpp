@@ -0,0 +1,24 @@
+#include "sampler.h"
+
+#include <emscripten/bind.h>
+
+EMSCRIPTEN_BINDINGS(audio_module)
+{
+  emscripten::class_<Sampler>("Sampler")
+    .constructor()
+    .function("loadSample", &Sampler::loadSample)
+    .function("loadImpulseResponse", &Sampler::loadImpulseResponse)
+    .function("trigger", &Sampler::trigger)
+    .function("prepare", &Sampler::prepare)
+    .function("process", &Sampler::process)
+    .function("setLooping", &Sampler::setLooping)
+    .function("setReverbMix", &Sampler::setReverbMix)
+    .function("setWaveshaperDrive", &Sampler::setWaveshaperDrive)
+    .function("setOTTAmount", &Sampler::setOTTAmount)
+    .function("setBpm", &Sampler::setBpm)
+    .function("setRenderCache", &Sampler::setRenderCache)
+    .function("setMetering", &Sampler::setMetering)
+    .function("getMeterFramePtr", &Sampler::getMeterFramePtr)
+    .function("getMeterFrameSize", &Sampler::getMeterFrameSize)
+    .function("getMeterFrameCount", &Sampler::getMeterFrameCount);
+}
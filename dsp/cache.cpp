@@ -0,0 +1,72 @@
+#include "cache.h"
+
+void RenderCache::prepare(size_t maxPeriod)
+{
+  left_.assign(maxPeriod, 0.0f);
+  right_.assign(maxPeriod, 0.0f);
+  invalidate();
+}
+
+void RenderCache::invalidate()
+{
+  valid_ = false;
+  capturedLength_ = 0;
+  currentLength_ = 0;
+  maxDifference_ = 0.0f;
+  periodClean_ = false;
+}
+
+void RenderCache::capture(const float* left, const float* right,
+                          const size_t* phases, int numSamples)
+{
+  for (int i = 0; i < numSamples; ++i) {
+    size_t phase = phases[i];
+
+    if (phase == 0) {
+      if (currentLength_ > 0)
+        endPeriod();
+      else
+        periodClean_ = true;
+    }
+
+    if (phase >= left_.size()) {
+      periodClean_ = false;
+      continue;
+    }
+
+    maxDifference_ = std::max(maxDifference_, std::abs(left[i] - left_[phase]));
+    maxDifference_ =
+      std::max(maxDifference_, std::abs(right[i] - right_[phase]));
+    left_[phase] = left[i];
+    right_[phase] = right[i];
+    currentLength_ = phase + 1;
+  }
+}
+
+void RenderCache::replay(float* left, float* right, size_t phase,
+                         int numSamples) const
+{
+  size_t count = static_cast<size_t>(numSamples);
+  size_t available = phase < capturedLength_ ? capturedLength_ - phase : 0;
+  size_t copyLen = std::min(count, available);
+
+  if (copyLen > 0) {
+    std::copy_n(left_.data() + phase, copyLen, left);
+    std::copy_n(right_.data() + phase, copyLen, right);
+  }
+  std::fill(left + copyLen, left + count, 0.0f);
+  std::fill(right + copyLen, right + count, 0.0f);
+}
+
+void RenderCache::endPeriod()
+{
+  // A period interrupted by invalidate() can't serve as the reference
+  if (periodClean_ && currentLength_ == capturedLength_ &&
+      maxDifference_ <= tolerance_)
+    valid_ = true;
+
+  capturedLength_ = periodClean_ ? currentLength_ : 0;
+  currentLength_ = 0;
+  maxDifference_ = 0.0f;
+  periodClean_ = true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Captures the pre-reverb output of one loop period and replays it once two
+// consecutive periods match, so an idle loop skips the sample, distortion and
+// OTT stages entirely. Samples are addressed by their phase within the beat;
+// phase 0 marks a retrigger.
+class RenderCache
+{
+public:
+  void prepare(size_t maxPeriod);
+  void invalidate();
+  bool isValid() const { return valid_; }
+  size_t getPeriodLength() const { return capturedLength_; }
+
+  void capture(const float* left, const float* right, const size_t* phases,
+               int numSamples);
+  void replay(float* left, float* right, size_t phase, int numSamples) const;
+
+private:
+  void endPeriod();
+
+  // About -100 dBFS; the OTT envelopes settle geometrically, so this is
+  // reached within a few beats
+  static constexpr float tolerance_ = 1e-5f;
+
+  std::vector<float> left_;
+  std::vector<float> right_;
+  size_t capturedLength_ = 0;
+  size_t currentLength_ = 0;
+  float maxDifference_ = 0.0f;
+  bool periodClean_ = false;
+  bool valid_ = false;
+};
@@ -8,19 +8,55 @@ void ConvolutionEngine::prepare(float sampleRate)
   reset();
 }
 
+std::shared_ptr<const PartitionedIR>
+ConvolutionEngine::partitionIR(const float* irData, size_t irLength)
+{
+  if (irLength == 0 || irData == nullptr)
+    return nullptr;
+
+  auto ir = std::make_shared<PartitionedIR>();
+  ConvolutionFFT fft{ fftOrder_ };
+
+  size_t numSegments = (irLength + segmentSize_ - 1) / segmentSize_;
+  ir->segments.resize(numSegments);
+
+  for (size_t seg = 0; seg < numSegments; ++seg) {
+    auto& segment = ir->segments[seg];
+    segment.resize(fftSize_ * 2, 0.0f);
+
+    size_t srcOffset = seg * segmentSize_;
+    size_t copyLen = std::min(segmentSize_, irLength - srcOffset);
+
+    for (size_t i = 0; i < copyLen; ++i) {
+      segment[i] = irData[srcOffset + i];
+    }
+
+    fft.forward(segment.data());
+  }
+
+  return ir;
+}
+
 void ConvolutionEngine::loadIR(const float* irData, size_t irLength)
 {
   if (irLength == 0 || irData == nullptr)
     return;
 
-  numSegments_ = (irLength + segmentSize_ - 1) / segmentSize_;
-  numInputSegments_ = numSegments_ * 3;
+  loadIR(partitionIR(irData, irLength));
+}
 
-  irSegmentsFFT_.resize(numSegments_);
-  for (auto& segment : irSegmentsFFT_) {
-    segment.resize(fftSize_ * 2, 0.0f);
+void ConvolutionEngine::loadIR(std::shared_ptr<const PartitionedIR> ir)
+{
+  // An empty IR unloads, so process() passes the input through
+  if (ir == nullptr || ir->segments.empty()) {
+    ir_ = nullptr;
+    irLoaded_ = false;
+    return;
   }
 
+  numSegments_ = ir->segments.size();
+  numInputSegments_ = numSegments_ * 3;
+
   inputSegmentsFFT_.resize(numInputSegments_);
   for (auto& segment : inputSegmentsFFT_) {
     segment.resize(fftSize_ * 2, 0.0f);
@@ -31,20 +67,7 @@ void ConvolutionEngine::loadIR(const float* irData, size_t irLength)
   overlapBuffer_.resize(fftSize_, 0.0f);
   tempBuffer_.resize(fftSize_ * 2, 0.0f);
 
-  for (size_t seg = 0; seg < numSegments_; ++seg) {
-    std::fill(irSegmentsFFT_[seg].begin(), irSegmentsFFT_[seg].end(), 0.0f);
-
-    size_t srcOffset = seg * segmentSize_;
-    size_t copyLen = std::min(segmentSize_, irLength - srcOffset);
-
-    for (size_t i = 0; i < copyLen; ++i) {
-      irSegmentsFFT_[seg][i] = irData[srcOffset + i];
-    }
-
-    fft_.performRealOnlyForwardTransform(irSegmentsFFT_[seg].data());
-    prepareForConvolution(irSegmentsFFT_[seg].data());
-  }
-
+  ir_ = std::move(ir);
   irLoaded_ = true;
   reset();
 }
@@ -56,6 +79,7 @@ void ConvolutionEngine::process(const float* input, float* output, int numSample
     return;
   }
 
+  const auto& irSegmentsFFT = ir_->segments;
   int numSamplesProcessed = 0;
   size_t indexStep = numInputSegments_ / numSegments_;
 
@@ -75,8 +99,7 @@ void ConvolutionEngine::process(const float* input, float* output, int numSample
       std::copy(inputBuffer_.begin(), inputBuffer_.end(), inputSegmentData);
       std::fill(
         inputSegmentData + fftSize_, inputSegmentData + fftSize_ * 2, 0.0f);
-      fft_.performRealOnlyForwardTransform(inputSegmentData);
-      prepareForConvolution(inputSegmentData);
+      fft_.forward(inputSegmentData);
 
       std::fill(tempBuffer_.begin(), tempBuffer_.end(), 0.0f);
 
@@ -87,17 +110,16 @@ void ConvolutionEngine::process(const float* input, float* output, int numSample
           index -= numInputSegments_;
 
         convolutionProcessingAndAccumulate(inputSegmentsFFT_[index].data(),
-                                           irSegmentsFFT_[seg].data(),
+                                           irSegmentsFFT[seg].data(),
                                            tempBuffer_.data());
       }
     }
 
     std::copy(tempBuffer_.begin(), tempBuffer_.end(), outputBuffer_.begin());
     convolutionProcessingAndAccumulate(
-      inputSegmentData, irSegmentsFFT_[0].data(), outputBuffer_.data());
+      inputSegmentData, irSegmentsFFT[0].data(), outputBuffer_.data());
 
-    updateSymmetricFrequencyDomainData(outputBuffer_.data());
-    fft_.performRealOnlyInverseTransform(outputBuffer_.data());
+    fft_.inverse(outputBuffer_.data());
 
     for (size_t i = 0; i < samplesToProcess; ++i) {
       output[numSamplesProcessed + i] =
@@ -144,19 +166,6 @@ void ConvolutionEngine::reset()
   }
 }
 
-void ConvolutionEngine::prepareForConvolution(float* samples)
-{
-  size_t halfSize = fftSize_ / 2;
-
-  for (size_t i = 0; i < halfSize; ++i)
-    samples[i] = samples[i << 1];
-
-  samples[halfSize] = 0.0f;
-
-  for (size_t i = 1; i < halfSize; ++i)
-    samples[i + halfSize] = -samples[((fftSize_ - i) << 1) + 1];
-}
-
 void ConvolutionEngine::convolutionProcessingAndAccumulate(const float* input,
                                                            const float* impulse,
                                                            float* output)
@@ -180,23 +189,6 @@ void ConvolutionEngine::convolutionProcessingAndAccumulate(const float* input,
   output[fftSize_] += input[fftSize_] * impulse[fftSize_];
 }
 
-void ConvolutionEngine::updateSymmetricFrequencyDomainData(float* samples)
-{
-  size_t halfSize = fftSize_ / 2;
-
-  for (size_t i = 1; i < halfSize; ++i) {
-    samples[(fftSize_ - i) << 1] = samples[i];
-    samples[((fftSize_ - i) << 1) + 1] = -samples[halfSize + i];
-  }
-
-  samples[1] = 0.0f;
-
-  for (size_t i = 1; i < halfSize; ++i) {
-    samples[i << 1] = samples[(fftSize_ - i) << 1];
-    samples[(i << 1) + 1] = -samples[((fftSize_ - i) << 1) + 1];
-  }
-}
-
 // --- StereoConvolutionReverb ---
 
 void StereoConvolutionReverb::prepare(float sampleRate)
@@ -206,25 +198,42 @@ void StereoConvolutionReverb::prepare(float sampleRate)
   dryBuffer_.resize(128 * 2);
 }
 
+StereoPartitionedIR StereoConvolutionReverb::partitionIR(
+  const float* irData,
+  size_t irLengthPerChannel,
+  int numChannels)
+{
+  if (numChannels == 1) {
+    auto ir = ConvolutionEngine::partitionIR(irData, irLengthPerChannel);
+    return { ir, ir };
+  }
+
+  std::vector<float> leftIR(irLengthPerChannel);
+  std::vector<float> rightIR(irLengthPerChannel);
+
+  for (size_t i = 0; i < irLengthPerChannel; ++i) {
+    leftIR[i] = irData[i * 2];
+    rightIR[i] = irData[i * 2 + 1];
+  }
+
+  return { ConvolutionEngine::partitionIR(leftIR.data(), irLengthPerChannel),
+           ConvolutionEngine::partitionIR(rightIR.data(), irLengthPerChannel) };
+}
+
 void StereoConvolutionReverb::loadIR(const float* irData,
                                      size_t irLengthPerChannel,
                                      int numChannels)
 {
-  if (numChannels == 1) {
-    leftEngine_.loadIR(irData, irLengthPerChannel);
-    rightEngine_.loadIR(irData, irLengthPerChannel);
-  } else {
-    std::vector<float> leftIR(irLengthPerChannel);
-    std::vector<float> rightIR(irLengthPerChannel);
-
-    for (size_t i = 0; i < irLengthPerChannel; ++i) {
-      leftIR[i] = irData[i * 2];
-      rightIR[i] = irData[i * 2 + 1];
-    }
+  if (irLengthPerChannel == 0 || irData == nullptr)
+    return;
 
-    leftEngine_.loadIR(leftIR.data(), irLengthPerChannel);
-    rightEngine_.loadIR(rightIR.data(), irLengthPerChannel);
-  }
+  loadIR(partitionIR(irData, irLengthPerChannel, numChannels));
+}
+
+void StereoConvolutionReverb::loadIR(const StereoPartitionedIR& ir)
+{
+  leftEngine_.loadIR(ir.left);
+  rightEngine_.loadIR(ir.right);
 }
 
 void StereoConvolutionReverb::process(float* left, float* right, int numSamples)
@@ -1,35 +1,46 @@
 #pragma once
 
+#include "fft.h"
+
 #include <algorithm>
 #include <cstring>
-#include <juce_dsp/juce_dsp.h>
+#include <memory>
 #include <vector>
 
+// FFT'd IR partitions. Immutable once built, so any number of engines can
+// share one copy.
+struct PartitionedIR
+{
+  std::vector<std::vector<float>> segments;
+};
+
 class ConvolutionEngine
 {
 public:
   ConvolutionEngine() = default;
 
+  static std::shared_ptr<const PartitionedIR> partitionIR(const float* irData,
+                                                          size_t irLength);
+
   void prepare(float sampleRate);
   void loadIR(const float* irData, size_t irLength);
+  void loadIR(std::shared_ptr<const PartitionedIR> ir);
   void process(const float* input, float* output, int numSamples);
   void reset();
 
 private:
-  void prepareForConvolution(float* samples);
   void convolutionProcessingAndAccumulate(const float* input,
                                           const float* impulse,
                                           float* output);
-  void updateSymmetricFrequencyDomainData(float* samples);
 
   static constexpr int fftOrder_ = 9;
   static constexpr size_t fftSize_ = 512;
   static constexpr size_t blockSize_ = 128;
   static constexpr size_t segmentSize_ = fftSize_ - blockSize_;
 
-  juce::dsp::FFT fft_{ fftOrder_ };
+  ConvolutionFFT fft_{ fftOrder_ };
 
-  std::vector<std::vector<float>> irSegmentsFFT_;
+  std::shared_ptr<const PartitionedIR> ir_;
   std::vector<std::vector<float>> inputSegmentsFFT_;
   std::vector<float> inputBuffer_;
   std::vector<float> outputBuffer_;
@@ -44,11 +55,22 @@ private:
   bool irLoaded_ = false;
 };
 
+struct StereoPartitionedIR
+{
+  std::shared_ptr<const PartitionedIR> left;
+  std::shared_ptr<const PartitionedIR> right;
+};
+
 class StereoConvolutionReverb
 {
 public:
+  static StereoPartitionedIR partitionIR(const float* irData,
+                                         size_t irLengthPerChannel,
+                                         int numChannels);
+
   void prepare(float sampleRate);
   void loadIR(const float* irData, size_t irLengthPerChannel, int numChannels);
+  void loadIR(const StereoPartitionedIR& ir);
   void process(float* left, float* right, int numSamples);
   void setMix(float wetLevel, float dryLevel);
   void reset();
@@ -0,0 +1,269 @@
+#include "fft.h"
+
+#include <cmath>
+#include <cstring>
+#include <numbers>
+
+namespace {
+
+#if defined(__GNUC__) || defined(__clang__)
+// Four-lane float vector; lowers to SSE/NEON natively and to wasm SIMD when
+// Emscripten is given -msimd128.
+using float4 = float __attribute__((vector_size(16)));
+
+inline float4 load(const float* p, float4)
+{
+  float4 v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline void store(float* p, float4 v)
+{
+  std::memcpy(p, &v, sizeof(v));
+}
+
+constexpr size_t simdWidth = 4;
+#endif
+
+inline float load(const float* p, float)
+{
+  return *p;
+}
+
+inline void store(float* p, float v)
+{
+  *p = v;
+}
+
+// Combines the half-length transform U with the two quarter-length
+// transforms Z and Z' into lanes k of a length-L block (quarter = L/4).
+template<typename V>
+inline void splitRadixButterfly(float* re, float* im, size_t k, size_t quarter,
+                                const float* w1Re, const float* w1Im,
+                                const float* w3Re, const float* w3Im)
+{
+  float* u0Re = re + k;
+  float* u0Im = im + k;
+  float* u1Re = u0Re + quarter;
+  float* u1Im = u0Im + quarter;
+  float* zRe = u1Re + quarter;
+  float* zIm = u1Im + quarter;
+  float* z3Re = zRe + quarter;
+  float* z3Im = zIm + quarter;
+
+  V tag{};
+  V c1 = load(w1Re + k, tag), s1 = load(w1Im + k, tag);
+  V c3 = load(w3Re + k, tag), s3 = load(w3Im + k, tag);
+  V zr = load(zRe, tag), zi = load(zIm, tag);
+  V z3r = load(z3Re, tag), z3i = load(z3Im, tag);
+
+  V ar = zr * c1 - zi * s1;
+  V ai = zr * s1 + zi * c1;
+  V br = z3r * c3 - z3i * s3;
+  V bi = z3r * s3 + z3i * c3;
+
+  V sr = ar + br, si = ai + bi;
+  V dr = ar - br, di = ai - bi;
+
+  V u0r = load(u0Re, tag), u0i = load(u0Im, tag);
+  V u1r = load(u1Re, tag), u1i = load(u1Im, tag);
+
+  store(u0Re, u0r + sr);
+  store(u0Im, u0i + si);
+  store(zRe, u0r - sr);
+  store(zIm, u0i - si);
+  store(u1Re, u1r + di);
+  store(u1Im, u1i - dr);
+  store(z3Re, u1r - di);
+  store(z3Im, u1i + dr);
+}
+
+} // namespace
+
+// --- JuceFFTBackend ---
+
+JuceFFTBackend::JuceFFTBackend(int order)
+  : fft_(order)
+  , size_(static_cast<size_t>(1) << order)
+{
+}
+
+void JuceFFTBackend::forward(float* data)
+{
+  fft_.performRealOnlyForwardTransform(data);
+
+  size_t halfSize = size_ / 2;
+
+  for (size_t i = 0; i < halfSize; ++i)
+    data[i] = data[i << 1];
+
+  data[halfSize] = 0.0f;
+
+  for (size_t i = 1; i < halfSize; ++i)
+    data[i + halfSize] = -data[((size_ - i) << 1) + 1];
+}
+
+void JuceFFTBackend::inverse(float* data)
+{
+  size_t halfSize = size_ / 2;
+
+  for (size_t i = 1; i < halfSize; ++i) {
+    data[(size_ - i) << 1] = data[i];
+    data[((size_ - i) << 1) + 1] = -data[halfSize + i];
+  }
+
+  data[1] = 0.0f;
+
+  for (size_t i = 1; i < halfSize; ++i) {
+    data[i << 1] = data[(size_ - i) << 1];
+    data[(i << 1) + 1] = -data[((size_ - i) << 1) + 1];
+  }
+
+  fft_.performRealOnlyInverseTransform(data);
+}
+
+// --- SplitRadixFFTBackend ---
+
+SplitRadixFFTBackend::SplitRadixFFTBackend(int order)
+  : size_(static_cast<size_t>(1) << order)
+  , halfSize_(size_ / 2)
+{
+  constexpr double twoPi = 2.0 * std::numbers::pi;
+
+  int halfOrder = order - 1;
+  bitReverse_.resize(halfSize_);
+  for (size_t i = 0; i < halfSize_; ++i) {
+    uint32_t reversed = 0;
+    for (int b = 0; b < halfOrder; ++b)
+      reversed |= ((i >> b) & 1u) << (halfOrder - 1 - b);
+    bitReverse_[i] = reversed;
+  }
+
+  size_t numTwiddles = halfSize_ >= 4 ? halfSize_ / 2 - 1 : 0;
+  w1Re_.resize(numTwiddles);
+  w1Im_.resize(numTwiddles);
+  w3Re_.resize(numTwiddles);
+  w3Im_.resize(numTwiddles);
+
+  for (size_t length = 4; length <= halfSize_; length <<= 1) {
+    size_t offset = length / 4 - 1;
+    for (size_t k = 0; k < length / 4; ++k) {
+      double angle = -twoPi * static_cast<double>(k) / length;
+      w1Re_[offset + k] = static_cast<float>(std::cos(angle));
+      w1Im_[offset + k] = static_cast<float>(std::sin(angle));
+      w3Re_[offset + k] = static_cast<float>(std::cos(3.0 * angle));
+      w3Im_[offset + k] = static_cast<float>(std::sin(3.0 * angle));
+    }
+  }
+
+  realTwRe_.resize(halfSize_);
+  realTwIm_.resize(halfSize_);
+  for (size_t k = 0; k < halfSize_; ++k) {
+    double angle = -twoPi * static_cast<double>(k) / size_;
+    realTwRe_[k] = static_cast<float>(std::cos(angle));
+    realTwIm_[k] = static_cast<float>(std::sin(angle));
+  }
+
+  re_.resize(halfSize_, 0.0f);
+  im_.resize(halfSize_, 0.0f);
+}
+
+void SplitRadixFFTBackend::forward(float* data)
+{
+  size_t m = halfSize_;
+
+  // Pack even/odd samples as one complex signal, in bit-reversed order
+  for (size_t n = 0; n < m; ++n) {
+    re_[bitReverse_[n]] = data[n << 1];
+    im_[bitReverse_[n]] = data[(n << 1) + 1];
+  }
+
+  transform(re_.data(), im_.data(), m);
+
+  // Untangle the even/odd spectra into the real-input spectrum
+  data[0] = re_[0] + im_[0];
+  data[m] = 0.0f;
+  data[size_] = re_[0] - im_[0];
+
+  for (size_t k = 1; k < m; ++k) {
+    float zr = re_[k], zi = im_[k];
+    float cr = re_[m - k], ci = -im_[m - k];
+
+    float er = 0.5f * (zr + cr);
+    float ei = 0.5f * (zi + ci);
+    float orr = 0.5f * (zi - ci);
+    float oi = -0.5f * (zr - cr);
+
+    float wr = realTwRe_[k], wi = realTwIm_[k];
+    data[k] = er + wr * orr - wi * oi;
+    data[m + k] = ei + wr * oi + wi * orr;
+  }
+}
+
+void SplitRadixFFTBackend::inverse(float* data)
+{
+  size_t m = halfSize_;
+
+  // Re-tangle into a half-length complex spectrum, conjugated so the forward
+  // transform computes the inverse
+  for (size_t k = 0; k < m; ++k) {
+    float xr = data[k];
+    float xi = k == 0 ? 0.0f : data[m + k];
+    float yr = k == 0 ? data[size_] : data[m - k];
+    float yi = k == 0 ? 0.0f : -data[m + m - k];
+
+    float er = xr + yr, ei = xi + yi;
+    float dr = xr - yr, di = xi - yi;
+
+    float wr = realTwRe_[k], wi = -realTwIm_[k];
+    float orr = dr * wr - di * wi;
+    float oi = dr * wi + di * wr;
+
+    re_[bitReverse_[k]] = er - oi;
+    im_[bitReverse_[k]] = -(ei + orr);
+  }
+
+  transform(re_.data(), im_.data(), m);
+
+  float scale = 1.0f / static_cast<float>(size_);
+  for (size_t n = 0; n < m; ++n) {
+    data[n << 1] = re_[n] * scale;
+    data[(n << 1) + 1] = -im_[n] * scale;
+  }
+}
+
+void SplitRadixFFTBackend::transform(float* re, float* im, size_t length) const
+{
+  if (length == 1)
+    return;
+
+  if (length == 2) {
+    float r0 = re[0], i0 = im[0];
+    re[0] = r0 + re[1];
+    im[0] = i0 + im[1];
+    re[1] = r0 - re[1];
+    im[1] = i0 - im[1];
+    return;
+  }
+
+  size_t half = length / 2;
+  size_t quarter = length / 4;
+
+  transform(re, im, half);
+  transform(re + half, im + half, quarter);
+  transform(re + half + quarter, im + half + quarter, quarter);
+
+  const float* w1Re = w1Re_.data() + quarter - 1;
+  const float* w1Im = w1Im_.data() + quarter - 1;
+  const float* w3Re = w3Re_.data() + quarter - 1;
+  const float* w3Im = w3Im_.data() + quarter - 1;
+
+  size_t k = 0;
+#if defined(__GNUC__) || defined(__clang__)
+  for (; k + simdWidth <= quarter; k += simdWidth)
+    splitRadixButterfly<float4>(re, im, k, quarter, w1Re, w1Im, w3Re, w3Im);
+#endif
+  for (; k < quarter; ++k)
+    splitRadixButterfly<float>(re, im, k, quarter, w1Re, w1Im, w3Re, w3Im);
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <juce_dsp/juce_dsp.h>
+#include <vector>
+
+// Real-FFT backends for ConvolutionEngine. Both transform in place and use the
+// packed half-spectrum layout that the multiply-accumulate kernel reads
+// directly, so no reshuffling is needed around each transform:
+//
+//   data[0 .. size/2)      real parts of bins 0 .. size/2 - 1
+//   data[size/2 .. size)   imaginary parts of bins 0 .. size/2 - 1 (bin 0 is 0)
+//   data[size]             real part of the Nyquist bin
+//
+// Buffers hold 2 * size floats (JUCE's requirement). inverse() scales by
+// 1 / size, so inverse(forward(x)) == x.
+template<typename T>
+concept RealFFTBackend = requires(T fft, float* data) {
+  fft.forward(data);
+  fft.inverse(data);
+  { fft.getSize() } -> std::convertible_to<size_t>;
+};
+
+// juce::dsp::FFT plus the layout conversion to and from its interleaved
+// full-spectrum format.
+class JuceFFTBackend
+{
+public:
+  explicit JuceFFTBackend(int order);
+
+  void forward(float* data);
+  void inverse(float* data);
+  size_t getSize() const { return size_; }
+
+private:
+  juce::dsp::FFT fft_;
+  size_t size_;
+};
+
+// Split-radix real FFT: a size/2 complex transform on split real/imaginary
+// arrays followed by a real-spectrum post-pass. Twiddles are precomputed per
+// recursion level and the butterflies run four lanes at a time.
+class SplitRadixFFTBackend
+{
+public:
+  explicit SplitRadixFFTBackend(int order);
+
+  void forward(float* data);
+  void inverse(float* data);
+  size_t getSize() const { return size_; }
+
+private:
+  void transform(float* re, float* im, size_t length) const;
+
+  size_t size_;
+  size_t halfSize_;
+
+  std::vector<uint32_t> bitReverse_;
+
+  // Butterfly twiddles w^k and w^3k for every level, level L at offset L/4 - 1
+  std::vector<float> w1Re_, w1Im_, w3Re_, w3Im_;
+
+  // Real post-pass twiddles e^(-2 pi i k / size)
+  std::vector<float> realTwRe_, realTwIm_;
+
+  std::vector<float> re_;
+  std::vector<float> im_;
+};
+
+static_assert(RealFFTBackend<JuceFFTBackend>);
+static_assert(RealFFTBackend<SplitRadixFFTBackend>);
+
+// Selected at build time with -DTHEREMIN_FFT_BACKEND=SplitRadix|Juce
+#ifndef THEREMIN_FFT_SPLIT_RADIX
+#define THEREMIN_FFT_SPLIT_RADIX 1
+#endif
+
+#if THEREMIN_FFT_SPLIT_RADIX
+using ConvolutionFFT = SplitRadixFFTBackend;
+#else
+using ConvolutionFFT = JuceFFTBackend;
+#endif
@@ -0,0 +1,127 @@
+#include "meter.h"
+
+// --- LevelMeter ---
+
+void LevelMeter::process(const float* left, const float* right, int numSamples)
+{
+  float peakL = peakL_, peakR = peakR_;
+  float sumL = 0.0f, sumR = 0.0f;
+
+  for (int i = 0; i < numSamples; ++i) {
+    peakL = std::max(peakL, std::abs(left[i]));
+    peakR = std::max(peakR, std::abs(right[i]));
+    sumL += left[i] * left[i];
+    sumR += right[i] * right[i];
+  }
+
+  peakL_ = peakL;
+  peakR_ = peakR;
+  sumSquaresL_ += sumL;
+  sumSquaresR_ += sumR;
+  numSamples_ += static_cast<size_t>(numSamples);
+}
+
+void LevelMeter::merge(const LevelMeter& other)
+{
+  peakL_ = std::max(peakL_, other.peakL_);
+  peakR_ = std::max(peakR_, other.peakR_);
+  sumSquaresL_ += other.sumSquaresL_;
+  sumSquaresR_ += other.sumSquaresR_;
+  numSamples_ += other.numSamples_;
+}
+
+void LevelMeter::reset()
+{
+  peakL_ = peakR_ = 0.0f;
+  sumSquaresL_ = sumSquaresR_ = 0.0f;
+  numSamples_ = 0;
+}
+
+void LevelMeter::readAndReset(float* peakRms)
+{
+  if (numSamples_ == 0)
+    return;
+
+  float count = static_cast<float>(numSamples_);
+
+  peakRms[0] = peakL_;
+  peakRms[1] = peakR_;
+  peakRms[2] = std::sqrt(sumSquaresL_ / count);
+  peakRms[3] = std::sqrt(sumSquaresR_ / count);
+
+  reset();
+}
+
+// --- SpectrumAnalyser ---
+
+void SpectrumAnalyser::prepare(float sampleRate)
+{
+  constexpr float twoPi = 2.0f * std::numbers::pi_v<float>;
+
+  window_.resize(fftSize_);
+  float windowSum = 0.0f;
+  for (size_t i = 0; i < fftSize_; ++i) {
+    window_[i] = 0.5f - 0.5f * std::cos(twoPi * i / fftSize_);
+    windowSum += window_[i];
+  }
+
+  // Full-scale sine reads 0 dBFS
+  magnitudeScale_ = 2.0f / windowSum;
+
+  size_t halfSize = fftSize_ / 2;
+  float binHz = sampleRate / fftSize_;
+  float maxFrequency = sampleRate * 0.5f;
+  int numBands = MeterFrame::numSpectrumBands;
+
+  bandEdges_.resize(numBands + 1);
+  for (int b = 0; b <= numBands; ++b) {
+    float frequency =
+      minFrequency_ *
+      std::pow(maxFrequency / minFrequency_, static_cast<float>(b) / numBands);
+    auto bin = static_cast<size_t>(frequency / binHz);
+    bandEdges_[b] = std::clamp<size_t>(bin, 1, halfSize);
+  }
+
+  std::fill(history_.begin(), history_.end(), 0.0f);
+  writePos_ = 0;
+}
+
+void SpectrumAnalyser::process(const float* left, const float* right,
+                               int numSamples)
+{
+  for (int i = 0; i < numSamples; ++i) {
+    history_[writePos_] = 0.5f * (left[i] + right[i]);
+    writePos_ = (writePos_ + 1) & (fftSize_ - 1);
+  }
+}
+
+void SpectrumAnalyser::captureWindow()
+{
+  for (size_t i = 0; i < fftSize_; ++i)
+    fftBuffer_[i] = history_[(writePos_ + i) & (fftSize_ - 1)] * window_[i];
+}
+
+void SpectrumAnalyser::transform()
+{
+  fft_.forward(fftBuffer_.data());
+}
+
+void SpectrumAnalyser::reduceBands(float* bandsDb)
+{
+  // Packed layout: real parts in [0, N/2), imaginary parts in [N/2, N)
+  size_t halfSize = fftSize_ / 2;
+  const float* re = fftBuffer_.data();
+  const float* im = fftBuffer_.data() + halfSize;
+
+  for (int b = 0; b < MeterFrame::numSpectrumBands; ++b) {
+    size_t lo = bandEdges_[b];
+    size_t hi = std::max(bandEdges_[b + 1], lo + 1);
+
+    float maxPower = 0.0f;
+    for (size_t k = lo; k < hi && k < halfSize; ++k)
+      maxPower = std::max(maxPower, re[k] * re[k] + im[k] * im[k]);
+
+    float magnitude = std::sqrt(maxPower) * magnitudeScale_;
+    bandsDb[b] = std::max(20.0f * std::log10(magnitude + 1e-9f), floorDb_);
+  }
+}
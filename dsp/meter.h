@@ -0,0 +1,79 @@
+#pragma once
+
+#include "fft.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+// One metering snapshot, published every MeterFrame::hopSize samples. Plain
+// floats so the worklet can copy it out of the WASM heap as a Float32Array;
+// frontend/src/meterFrame.ts mirrors this layout.
+struct MeterFrame
+{
+  static constexpr int numStages = 4;
+  static constexpr int numOTTBands = 3;
+  static constexpr int numSpectrumBands = 64;
+  static constexpr size_t hopSize = 512;
+
+  // { peakL, peakR, rmsL, rmsR } (linear) for pre-distortion, post-distortion,
+  // post-OTT and post-reverb
+  float levels[numStages][4];
+
+  // Deepest gain reduction per OTT band since the last frame, in dB (<= 0)
+  float ottGainReductionDb[numOTTBands];
+
+  // Post-reverb spectrum in log-spaced bands, in dBFS
+  float spectrumDb[numSpectrumBands];
+};
+
+static_assert(sizeof(MeterFrame) % sizeof(float) == 0);
+
+// Peak and RMS accumulator for one point in the signal chain.
+class LevelMeter
+{
+public:
+  void process(const float* left, const float* right, int numSamples);
+  // Adds other's readings as if its samples had been processed here
+  void merge(const LevelMeter& other);
+  void reset();
+  // Leaves peakRms untouched if nothing was metered since the last read
+  void readAndReset(float* peakRms);
+
+private:
+  float peakL_ = 0.0f;
+  float peakR_ = 0.0f;
+  float sumSquaresL_ = 0.0f;
+  float sumSquaresR_ = 0.0f;
+  size_t numSamples_ = 0;
+};
+
+// Keeps the last fftSize mono samples and reduces their windowed spectrum to
+// MeterFrame::numSpectrumBands log-spaced bands. The analysis is split into
+// three steps so the caller can spread it over consecutive blocks.
+class SpectrumAnalyser
+{
+public:
+  void prepare(float sampleRate);
+  void process(const float* left, const float* right, int numSamples);
+
+  void captureWindow();
+  void transform();
+  void reduceBands(float* bandsDb);
+
+private:
+  static constexpr int fftOrder_ = 10;
+  static constexpr size_t fftSize_ = 1024;
+  static constexpr float minFrequency_ = 20.0f;
+  static constexpr float floorDb_ = -120.0f;
+
+  ConvolutionFFT fft_{ fftOrder_ };
+
+  std::vector<float> history_ = std::vector<float>(fftSize_, 0.0f);
+  std::vector<float> window_;
+  std::vector<float> fftBuffer_ = std::vector<float>(fftSize_ * 2, 0.0f);
+  std::vector<size_t> bandEdges_;
+  size_t writePos_ = 0;
+  float magnitudeScale_ = 1.0f;
+};
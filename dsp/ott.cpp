@@ -20,6 +20,7 @@ void BandCompressor::prepare(float sampleRate)
   releaseCoeff_ = std::exp(-1.0f / (releaseMs_ * 0.001f * sampleRate));
   envelopeL_ = 0.0f;
   envelopeR_ = 0.0f;
+  gainReductionDb_ = 0.0f;
 }
 
 void BandCompressor::process(float* left, float* right, int numSamples,
@@ -52,10 +53,31 @@ float BandCompressor::processSample(float sample, float& envelope,
     gainDb = (1.0f - 1.0f / upRatio) * (upThresholdDb_ - envelopeDb);
   }
 
+  gainReductionDb_ = std::min(gainReductionDb_, gainDb);
+
   float gain = std::pow(10.0f, gainDb / 20.0f);
   return sample * gain;
 }
 
+float BandCompressor::takeGainReductionDb()
+{
+  float reduction = gainReductionDb_;
+  gainReductionDb_ = 0.0f;
+  return reduction;
+}
+
+BandCompressor::State BandCompressor::getState() const
+{
+  return { envelopeL_, envelopeR_, gainReductionDb_ };
+}
+
+void BandCompressor::setState(const State& state)
+{
+  envelopeL_ = state.envelopeL;
+  envelopeR_ = state.envelopeR;
+  gainReductionDb_ = state.gainReductionDb;
+}
+
 // --- OTTCompressor ---
 
 OTTCompressor::OTTCompressor()
@@ -126,3 +148,43 @@ void OTTCompressor::process(float* left, float* right, int numSamples)
 }
 
 void OTTCompressor::setAmount(float amount) { amount_ = amount; }
+
+float OTTCompressor::takeGainReductionDb(int band)
+{
+  switch (band) {
+    case 0:
+      return lowComp_.takeGainReductionDb();
+    case 1:
+      return midComp_.takeGainReductionDb();
+    default:
+      return highComp_.takeGainReductionDb();
+  }
+}
+
+void OTTCompressor::resetGainReduction()
+{
+  for (int band = 0; band < numBands; ++band)
+    takeGainReductionDb(band);
+}
+
+void OTTCompressor::saveState(State& state) const
+{
+  state.lowCrossoverLP = lowCrossoverLP_;
+  state.lowCrossoverHP = lowCrossoverHP_;
+  state.highCrossoverLP = highCrossoverLP_;
+  state.highCrossoverHP = highCrossoverHP_;
+  state.low = lowComp_.getState();
+  state.mid = midComp_.getState();
+  state.high = highComp_.getState();
+}
+
+void OTTCompressor::restoreState(const State& state)
+{
+  lowCrossoverLP_ = state.lowCrossoverLP;
+  lowCrossoverHP_ = state.lowCrossoverHP;
+  highCrossoverLP_ = state.highCrossoverLP;
+  highCrossoverHP_ = state.highCrossoverHP;
+  lowComp_.setState(state.low);
+  midComp_.setState(state.mid);
+  highComp_.setState(state.high);
+}
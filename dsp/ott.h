@@ -11,8 +11,19 @@ public:
                  float downThresholdDb, float downRatio,
                  float upThresholdDb, float upRatio);
 
+  struct State
+  {
+    float envelopeL = 0.0f;
+    float envelopeR = 0.0f;
+    float gainReductionDb = 0.0f;
+  };
+
   void prepare(float sampleRate);
   void process(float* left, float* right, int numSamples, float amount);
+  float takeGainReductionDb();
+
+  State getState() const;
+  void setState(const State& state);
 
 private:
   float processSample(float sample, float& envelope,
@@ -25,6 +36,7 @@ private:
   float releaseCoeff_ = 0.0f;
   float envelopeL_ = 0.0f;
   float envelopeR_ = 0.0f;
+  float gainReductionDb_ = 0.0f;
 };
 
 class OTTCompressor
@@ -35,6 +47,25 @@ public:
   void prepare(float sampleRate);
   void process(float* left, float* right, int numSamples);
   void setAmount(float amount);
+  float takeGainReductionDb(int band);
+  void resetGainReduction();
+
+  // Crossover and envelope state, so a caller can rewind the compressor to
+  // an earlier point in the signal. Save into a State once after prepare()
+  // so later saves reuse its filter buffers.
+  struct State
+  {
+    juce::dsp::LinkwitzRileyFilter<float> lowCrossoverLP;
+    juce::dsp::LinkwitzRileyFilter<float> lowCrossoverHP;
+    juce::dsp::LinkwitzRileyFilter<float> highCrossoverLP;
+    juce::dsp::LinkwitzRileyFilter<float> highCrossoverHP;
+    BandCompressor::State low, mid, high;
+  };
+
+  void saveState(State& state) const;
+  void restoreState(const State& state);
+
+  static constexpr int numBands = 3;
 
 private:
   juce::dsp::LinkwitzRileyFilter<float> lowCrossoverLP_;
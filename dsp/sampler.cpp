@@ -1,114 +1,373 @@
-#include "convolution.h"
-#include "distortion.h"
-#include "ott.h"
+#include "sampler.h"
 
-#include <emscripten/bind.h>
+void Sampler::setLooping(bool inLoop)
+{
+  if (replaying_)
+    stopReplay();
+
+  inLoop_ = inLoop;
+  if (inLoop_) {
+    trigger();
+    loopPosition_ = 0;
+    beatPhase_ = 0;
+  }
+}
+
+void Sampler::loadSample(uintptr_t samplePtr, size_t sampleLength)
+{
+  invalidateRenderCache();
+  sampleData_ = reinterpret_cast<float*>(samplePtr);
+  sampleLength_ = sampleLength;
+}
+
+void Sampler::loadImpulseResponse(uintptr_t irPtr,
+                                  size_t irLength,
+                                  int numChannels)
+{
+  const float* irData = reinterpret_cast<const float*>(irPtr);
+  convolutionReverb_.loadIR(irData, irLength, numChannels);
+}
+
+void Sampler::setImpulseResponse(const StereoPartitionedIR& ir)
+{
+  convolutionReverb_.loadIR(ir);
+}
 
-class Sampler
+void Sampler::prepare(float sampleRate)
 {
-public:
-  Sampler() = default;
+  sampleRate_ = sampleRate;
+  samplePosition_ = 0;
+  samplesPerBeat_ = sampleRate_ / bpm_ * 60;
 
-  void setLooping(bool inLoop)
-  {
-    inLoop_ = inLoop;
+  convolutionReverb_.prepare(sampleRate);
+  ottCompressor_.prepare(sampleRate);
+  distortion_.prepare(sampleRate);
+  spectrumAnalyser_.prepare(sampleRate);
+
+  // Longest loop period at any tempo setBpm() accepts, so changing tempo
+  // never reallocates on the audio thread
+  size_t maxPeriod = static_cast<size_t>(sampleRate_ / minBpm * 60) + 2;
+  renderCache_.prepare(maxPeriod);
+
+  // Save into every checkpoint once here so later saves don't allocate
+  replaying_ = false;
+  openCheckpoint_ = noCheckpoint_;
+  loopCheckpoints_.resize(maxPeriod / checkpointInterval_ + 1);
+  for (auto& checkpoint : loopCheckpoints_)
+    ottCompressor_.saveState(checkpoint.ott);
+
+  std::fill(std::begin(ottGainReductionDb_), std::end(ottGainReductionDb_),
+            0.0f);
+}
+
+void Sampler::trigger()
+{
+  invalidateRenderCache();
+  samplePosition_ = 0;
+}
+
+void Sampler::process(uintptr_t leftPtr, uintptr_t rightPtr, int numSamples)
+{
+  float* left = reinterpret_cast<float*>(leftPtr);
+  float* right = reinterpret_cast<float*>(rightPtr);
+
+  if (replaying_)
+    replayLoop(left, right, numSamples);
+  else
+    renderChain(left, right, numSamples);
+
+  if (!meteringEnabled_) {
+    convolutionReverb_.process(left, right, numSamples);
+    return;
+  }
+
+  stageMeters_[2].process(left, right, numSamples);
+  convolutionReverb_.process(left, right, numSamples);
+  stageMeters_[3].process(left, right, numSamples);
+  spectrumAnalyser_.process(left, right, numSamples);
+
+  // One analysis step per block: window, FFT, then bands + publish, so no
+  // single block carries the whole hop's work
+  switch (meterStep_) {
+    case 1:
+      spectrumAnalyser_.transform();
+      meterStep_ = 2;
+      break;
+    case 2:
+      publishMeterFrame();
+      meterStep_ = 0;
+      break;
+  }
+
+  meterSamples_ += static_cast<size_t>(numSamples);
+  if (meterSamples_ >= MeterFrame::hopSize) {
+    meterSamples_ = 0;
+
+    // Blocks larger than a third of the hop: finish the previous frame first
+    if (meterStep_ == 2)
+      publishMeterFrame();
+
+    spectrumAnalyser_.captureWindow();
+    meterStep_ = 1;
+  }
+}
+
+void Sampler::setReverbMix(float wetLevel, float dryLevel)
+{
+  convolutionReverb_.setMix(wetLevel, dryLevel);
+}
+
+void Sampler::setWaveshaperDrive(float drive)
+{
+  invalidateRenderCache();
+  distortion_.setDrive(drive);
+}
+
+void Sampler::setOTTAmount(float amount)
+{
+  invalidateRenderCache();
+  ottCompressor_.setAmount(amount);
+}
+
+void Sampler::setBpm(float bpm)
+{
+  invalidateRenderCache();
+
+  // Argument order sends NaN to minBpm
+  bpm_ = std::min(std::max(minBpm, bpm), maxBpm);
+  samplesPerBeat_ = sampleRate_ / bpm_ * 60;
+}
+
+void Sampler::setRenderCache(bool enabled)
+{
+  invalidateRenderCache();
+  renderCacheEnabled_ = enabled;
+}
+
+void Sampler::setMetering(bool enabled)
+{
+  meteringEnabled_ = enabled;
+  meterSamples_ = 0;
+  meterStep_ = 0;
+
+  // Gain reduction is tracked regardless; drop whatever built up while
+  // metering was off so the first frame only covers its own hop
+  if (enabled) {
+    ottCompressor_.resetGainReduction();
+    std::fill(std::begin(ottGainReductionDb_), std::end(ottGainReductionDb_),
+              0.0f);
+  }
+}
+
+// Sample playback, distortion and OTT. While looping, each sample is
+// tagged with its phase in the beat so the render cache can capture it.
+void Sampler::renderChain(float* left, float* right, int numSamples)
+{
+  if (blockPhases_.size() < static_cast<size_t>(numSamples))
+    blockPhases_.resize(numSamples);
+
+  for (int i = 0; i < numSamples; ++i) {
     if (inLoop_) {
-      trigger();
-      loopPosition_ = 0;
+      if (loopPosition_ > samplesPerBeat_) {
+        loopPosition_ = 0;
+        samplePosition_ = 0;
+        beatPhase_ = 0;
+      } else {
+        ++loopPosition_;
+      }
+    }
+    blockPhases_[i] = beatPhase_++;
+
+    float sample = 0.0f;
+    if (samplePosition_ < sampleLength_) {
+      sample = sampleData_[samplePosition_];
+      ++samplePosition_;
     }
+    left[i] = sample;
+    right[i] = sample;
   }
 
-  void loadSample(uintptr_t samplePtr, size_t sampleLength)
-  {
-    sampleData_ = reinterpret_cast<float*>(samplePtr);
-    sampleLength_ = sampleLength;
+  if (!(inLoop_ && renderCacheEnabled_)) {
+    openCheckpoint_ = noCheckpoint_;
+    processChain(left, right, numSamples);
+    return;
   }
 
-  void loadImpulseResponse(uintptr_t irPtr, size_t irLength, int numChannels)
-  {
-    const float* irData = reinterpret_cast<const float*>(irPtr);
-    convolutionReverb_.loadIR(irData, irLength, numChannels);
+  // Split the chain at every checkpoint phase
+  int start = 0;
+  for (int i = 0; i < numSamples; ++i) {
+    if (blockPhases_[i] % checkpointInterval_ != 0)
+      continue;
+    processChain(left + start, right + start, i - start);
+    beginCheckpoint(blockPhases_[i] / checkpointInterval_);
+    start = i;
   }
+  processChain(left + start, right + start, numSamples - start);
+
+  renderCache_.capture(left, right, blockPhases_.data(), numSamples);
+  replaying_ = renderCache_.isValid();
+}
+
+// Distortion and OTT with their meters, also filed under the open checkpoint
+void Sampler::processChain(float* left, float* right, int numSamples)
+{
+  bool checkpointOpen = openCheckpoint_ != noCheckpoint_;
+
+  if (meteringEnabled_)
+    stageMeters_[0].process(left, right, numSamples);
+  if (checkpointOpen)
+    checkpointMeters_[0].process(left, right, numSamples);
 
-  void prepare(float sampleRate)
-  {
-    sampleRate_ = sampleRate;
-    samplePosition_ = 0;
-    samplesPerBeat_ = sampleRate_ / bpm_ * 60;
+  distortion_.process(left, right, numSamples);
 
-    convolutionReverb_.prepare(sampleRate);
-    ottCompressor_.prepare(sampleRate);
-    distortion_.prepare(sampleRate);
+  if (meteringEnabled_)
+    stageMeters_[1].process(left, right, numSamples);
+  if (checkpointOpen)
+    checkpointMeters_[1].process(left, right, numSamples);
+
+  ottCompressor_.process(left, right, numSamples);
+
+  for (int b = 0; b < MeterFrame::numOTTBands; ++b) {
+    float reduction = ottCompressor_.takeGainReductionDb(b);
+    ottGainReductionDb_[b] = std::min(ottGainReductionDb_[b], reduction);
+    if (checkpointOpen)
+      checkpointGainReductionDb_[b] =
+        std::min(checkpointGainReductionDb_[b], reduction);
   }
+}
 
-  void trigger() { samplePosition_ = 0; }
-
-  void process(uintptr_t leftPtr, uintptr_t rightPtr, int numSamples)
-  {
-    float* left = reinterpret_cast<float*>(leftPtr);
-    float* right = reinterpret_cast<float*>(rightPtr);
-
-    for (int i = 0; i < numSamples; ++i) {
-      if (inLoop_) {
-        if (loopPosition_ > samplesPerBeat_) {
-          loopPosition_ = 0;
-          trigger();
-        } else {
-          ++loopPosition_;
-        }
-      }
+// Files the readings of the checkpoint that just ended, if the live chain
+// ran through all of it, then saves the OTT state for the next one
+void Sampler::beginCheckpoint(size_t index)
+{
+  if (openCheckpoint_ != noCheckpoint_) {
+    LoopCheckpoint& finished = loopCheckpoints_[openCheckpoint_];
+    for (int s = 0; s < 2; ++s) {
+      finished.stageMeters[s] = checkpointMeters_[s];
+      checkpointMeters_[s].reset();
+    }
+    std::copy(std::begin(checkpointGainReductionDb_),
+              std::end(checkpointGainReductionDb_),
+              finished.ottGainReductionDb);
+  }
 
-      float sample = 0.0f;
-      if (samplePosition_ < sampleLength_) {
-        sample = sampleData_[samplePosition_];
-        ++samplePosition_;
-      }
-      left[i] = sample;
-      right[i] = sample;
+  if (index >= loopCheckpoints_.size()) {
+    openCheckpoint_ = noCheckpoint_;
+    return;
+  }
+
+  ottCompressor_.saveState(loopCheckpoints_[index].ott);
+  for (auto& meter : checkpointMeters_)
+    meter.reset();
+  std::fill(std::begin(checkpointGainReductionDb_),
+            std::end(checkpointGainReductionDb_),
+            0.0f);
+  openCheckpoint_ = index;
+}
+
+// Same loop bookkeeping as renderChain(), but copies whole runs between
+// retriggers out of the render cache
+void Sampler::replayLoop(float* left, float* right, int numSamples)
+{
+  int i = 0;
+  while (i < numSamples) {
+    size_t run = 1;
+    if (loopPosition_ > samplesPerBeat_) {
+      loopPosition_ = 0;
+      beatPhase_ = 0;
+    } else {
+      run = std::min(static_cast<size_t>(numSamples - i),
+                     samplesPerBeat_ + 1 - loopPosition_);
+      loopPosition_ += run;
     }
 
-    distortion_.process(left, right, numSamples);
-    ottCompressor_.process(left, right, numSamples);
-    convolutionReverb_.process(left, right, numSamples);
+    renderCache_.replay(
+      left + i, right + i, beatPhase_, static_cast<int>(run));
+    if (meteringEnabled_)
+      replayCheckpoints(beatPhase_, run);
+    beatPhase_ += run;
+    i += static_cast<int>(run);
   }
 
-  void setReverbMix(float wetLevel, float dryLevel)
-  {
-    convolutionReverb_.setMix(wetLevel, dryLevel);
+  samplePosition_ = std::min(beatPhase_, sampleLength_);
+}
+
+// Hands back to the live chain at the current phase: rewinds the OTT to the
+// last checkpoint and silently re-runs the chain up to the phase, at most
+// checkpointInterval_ samples. Must run before the cache is invalidated and
+// before any parameter changes, so the re-run matches the replayed audio.
+// Feeds the skipped stages' meters with the readings of every checkpoint
+// starting in [phase, phase + run), so they keep moving at checkpoint
+// resolution while replaying
+void Sampler::replayCheckpoints(size_t phase, size_t run)
+{
+  size_t end = std::min(phase + run, renderCache_.getPeriodLength());
+  size_t index = (phase + checkpointInterval_ - 1) / checkpointInterval_;
+
+  for (; index * checkpointInterval_ < end; ++index) {
+    const LoopCheckpoint& checkpoint = loopCheckpoints_[index];
+    stageMeters_[0].merge(checkpoint.stageMeters[0]);
+    stageMeters_[1].merge(checkpoint.stageMeters[1]);
+    for (int b = 0; b < MeterFrame::numOTTBands; ++b)
+      ottGainReductionDb_[b] =
+        std::min(ottGainReductionDb_[b], checkpoint.ottGainReductionDb[b]);
   }
+}
+
+void Sampler::stopReplay()
+{
+  replaying_ = false;
+  openCheckpoint_ = noCheckpoint_;
+
+  // At the very end of a period the next checkpoint is the retrigger's,
+  // which belongs to the following period
+  size_t periodLength = renderCache_.getPeriodLength();
+  size_t checkpoint =
+    std::min(beatPhase_, periodLength - 1) / checkpointInterval_;
+  ottCompressor_.restoreState(loopCheckpoints_[checkpoint].ott);
 
-  void setWaveshaperDrive(float drive) { distortion_.setDrive(drive); }
+  float left[checkpointInterval_];
+  float right[checkpointInterval_];
+  size_t phase = checkpoint * checkpointInterval_;
+  int count = static_cast<int>(beatPhase_ - phase);
 
-  void setOTTAmount(float amount) { ottCompressor_.setAmount(amount); }
+  // Within a period the sample plays from phase 0, so its position is the
+  // phase
+  for (int i = 0; i < count; ++i, ++phase) {
+    float sample = phase < sampleLength_ ? sampleData_[phase] : 0.0f;
+    left[i] = sample;
+    right[i] = sample;
+  }
 
-private:
-  float sampleRate_ = 44100.0f;
+  distortion_.process(left, right, count);
+  ottCompressor_.process(left, right, count);
 
-  float* sampleData_ = nullptr;
-  size_t sampleLength_ = 0;
-  size_t samplePosition_ = 0;
+  // Already metered from the checkpoint when replay passed it
+  ottCompressor_.resetGainReduction();
 
-  float bpm_ = 140;
-  size_t samplesPerBeat_ = 0;
-  size_t loopPosition_ = 0;
-  bool inLoop_ = false;
+  samplePosition_ = std::min(beatPhase_, sampleLength_);
+}
 
-  Distortion distortion_;
-  OTTCompressor ottCompressor_;
-  StereoConvolutionReverb convolutionReverb_;
-};
+// Drops the cached period. If it is being replayed, the live chain takes
+// over first, while the parameters it was rendered with still apply.
+void Sampler::invalidateRenderCache()
+{
+  if (replaying_)
+    stopReplay();
+  renderCache_.invalidate();
+  openCheckpoint_ = noCheckpoint_;
+}
 
-EMSCRIPTEN_BINDINGS(audio_module)
+void Sampler::publishMeterFrame()
 {
-  emscripten::class_<Sampler>("Sampler")
-    .constructor()
-    .function("loadSample", &Sampler::loadSample)
-    .function("loadImpulseResponse", &Sampler::loadImpulseResponse)
-    .function("trigger", &Sampler::trigger)
-    .function("prepare", &Sampler::prepare)
-    .function("process", &Sampler::process)
-    .function("setLooping", &Sampler::setLooping)
-    .function("setReverbMix", &Sampler::setReverbMix)
-    .function("setWaveshaperDrive", &Sampler::setWaveshaperDrive)
-    .function("setOTTAmount", &Sampler::setOTTAmount);
+  for (int s = 0; s < MeterFrame::numStages; ++s)
+    stageMeters_[s].readAndReset(meterFrame_.levels[s]);
+
+  for (int b = 0; b < MeterFrame::numOTTBands; ++b) {
+    meterFrame_.ottGainReductionDb[b] = ottGainReductionDb_[b];
+    ottGainReductionDb_[b] = 0.0f;
+  }
+
+  spectrumAnalyser_.reduceBands(meterFrame_.spectrumDb);
+  ++meterFrameCount_;
 }
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "cache.h"
+#include "convolution.h"
+#include "distortion.h"
+#include "meter.h"
+#include "ott.h"
+
+#include <cstdint>
+#include <vector>
+
+class Sampler
+{
+public:
+  Sampler() = default;
+
+  // setBpm() clamps to this range; the render cache is sized for minBpm
+  static constexpr float minBpm = 20.0f;
+  static constexpr float maxBpm = 300.0f;
+
+  void setLooping(bool inLoop);
+  void loadSample(uintptr_t samplePtr, size_t sampleLength);
+  void loadImpulseResponse(uintptr_t irPtr, size_t irLength, int numChannels);
+  void setImpulseResponse(const StereoPartitionedIR& ir);
+  void prepare(float sampleRate);
+  void trigger();
+  void process(uintptr_t leftPtr, uintptr_t rightPtr, int numSamples);
+
+  void setReverbMix(float wetLevel, float dryLevel);
+  void setWaveshaperDrive(float drive);
+  void setOTTAmount(float amount);
+  void setBpm(float bpm);
+  void setRenderCache(bool enabled);
+  void setMetering(bool enabled);
+
+  // The worklet polls getMeterFrameCount() after each process() and copies
+  // the frame at getMeterFramePtr() out when it changes
+  uintptr_t getMeterFramePtr() const
+  {
+    return reinterpret_cast<uintptr_t>(&meterFrame_);
+  }
+
+  int getMeterFrameSize() const
+  {
+    return static_cast<int>(sizeof(MeterFrame) / sizeof(float));
+  }
+
+  uint32_t getMeterFrameCount() const { return meterFrameCount_; }
+
+private:
+  void renderChain(float* left, float* right, int numSamples);
+  void processChain(float* left, float* right, int numSamples);
+  void beginCheckpoint(size_t index);
+  void replayLoop(float* left, float* right, int numSamples);
+  void replayCheckpoints(size_t phase, size_t run);
+  void stopReplay();
+  void invalidateRenderCache();
+  void publishMeterFrame();
+
+  float sampleRate_ = 44100.0f;
+
+  float* sampleData_ = nullptr;
+  size_t sampleLength_ = 0;
+  size_t samplePosition_ = 0;
+
+  float bpm_ = 140;
+  size_t samplesPerBeat_ = 0;
+  size_t loopPosition_ = 0;
+  size_t beatPhase_ = 0;
+  bool inLoop_ = false;
+
+  bool renderCacheEnabled_ = false;
+  RenderCache renderCache_;
+  std::vector<size_t> blockPhases_;
+
+  // Saved by the live chain every checkpointInterval_ phases of the beat,
+  // next to the audio in renderCache_: the OTT state at the checkpoint, so
+  // replay can hand back to the live chain at any phase, and the meter
+  // readings of the skipped stages up to the next one, so replay can feed
+  // them to the meters
+  struct LoopCheckpoint
+  {
+    OTTCompressor::State ott;
+    LevelMeter stageMeters[2];
+    float ottGainReductionDb[MeterFrame::numOTTBands];
+  };
+
+  static constexpr size_t checkpointInterval_ = 128;
+  static constexpr size_t noCheckpoint_ = static_cast<size_t>(-1);
+
+  bool replaying_ = false;
+  std::vector<LoopCheckpoint> loopCheckpoints_;
+
+  // Readings for the checkpoint the live chain is in, filed when it ends
+  size_t openCheckpoint_ = noCheckpoint_;
+  LevelMeter checkpointMeters_[2];
+  float checkpointGainReductionDb_[MeterFrame::numOTTBands] = {};
+
+  Distortion distortion_;
+  OTTCompressor ottCompressor_;
+  StereoConvolutionReverb convolutionReverb_;
+
+  bool meteringEnabled_ = false;
+  LevelMeter stageMeters_[MeterFrame::numStages];
+  SpectrumAnalyser spectrumAnalyser_;
+  MeterFrame meterFrame_{};
+  float ottGainReductionDb_[MeterFrame::numOTTBands] = {};
+  size_t meterSamples_ = 0;
+  int meterStep_ = 0;
+  uint32_t meterFrameCount_ = 0;
+};
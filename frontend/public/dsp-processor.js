@@ -5,6 +5,11 @@ class DSPProcessor extends AudioWorkletProcessor {
     this.module = null;
     this.heapBufferLeft = null;
     this.heapBufferRight = null;
+    this.meterSlots = null;
+    this.meterState = null;
+    this.meterBack = 0;
+    this.meterFrameCount = 0;
+    this.meterView = null;
     this.port.onmessage = (e) => this.handleMessage(e.data);
   }
 
@@ -17,8 +22,10 @@ class DSPProcessor extends AudioWorkletProcessor {
       const module = await createAudioEngine();
       this.engine = new module.Sampler();
       this.engine.prepare(sampleRate);
+      this.engine.setRenderCache(true);
       this.module = module;
-      this.port.postMessage({ type: "ready" });
+      const meterBuffer = this.createMeterBuffer();
+      this.port.postMessage({ type: "ready", meterBuffer });
     }
     if (data.type === "loadSample") {
       const samplePtr = this.module._malloc(data.samples.length * 4);
@@ -47,12 +54,55 @@ class DSPProcessor extends AudioWorkletProcessor {
     if (data.type === "distortionAmount") {
       this.engine?.setWaveshaperDrive(data.drive);
     }
+    // set loop tempo
+    if (data.type === "bpm") {
+      this.engine?.setBpm(data.bpm);
+    }
     // set reverb dry/wet
     if (data.type === "reverbMix") {
       this.engine?.setReverbMix(data.wet, data.dry);
     }
   }
 
+  // Metering triple buffer, shared with the main thread:
+  //   Int32 [0]          middle slot index, | 4 when it holds a fresh frame
+  //   Float32 [4 + ...]  three slots of getMeterFrameSize() floats
+  // The worklet owns the back slot, the UI owns the front slot, and they swap
+  // with the middle one via Atomics.exchange, so neither side ever blocks.
+  createMeterBuffer() {
+    if (typeof SharedArrayBuffer === "undefined") return null;
+
+    const frameSize = this.engine.getMeterFrameSize();
+    const buffer = new SharedArrayBuffer((4 + frameSize * 3) * 4);
+    this.meterState = new Int32Array(buffer, 0, 1);
+    this.meterSlots = [0, 1, 2].map(
+      (slot) => new Float32Array(buffer, (4 + slot * frameSize) * 4, frameSize),
+    );
+    Atomics.store(this.meterState, 0, 1);
+    this.meterBack = 0;
+    this.engine.setMetering(true);
+    return buffer;
+  }
+
+  publishMeterFrame() {
+    const frameCount = this.engine.getMeterFrameCount();
+    if (frameCount === this.meterFrameCount) return;
+    this.meterFrameCount = frameCount;
+
+    // refresh the heap view only if the WASM memory was replaced
+    if (!this.meterView || this.meterView.buffer !== this.module.HEAPF32.buffer) {
+      const offset = this.engine.getMeterFramePtr() / 4;
+      this.meterView = this.module.HEAPF32.subarray(
+        offset,
+        offset + this.engine.getMeterFrameSize(),
+      );
+    }
+
+    this.meterSlots[this.meterBack].set(this.meterView);
+    const previous = Atomics.exchange(this.meterState, 0, this.meterBack | 4);
+    this.meterBack = previous & 3;
+  }
+
   process(inputs, outputs, parameters) {
     // if engine or module missing, return but keep processor alive
     if (!this.engine || !this.module) return true;
@@ -87,6 +137,9 @@ class DSPProcessor extends AudioWorkletProcessor {
     leftOutput.set(wasmLeft);
     rightOutput.set(wasmRight);
 
+    // hand any new meter frame to the UI
+    if (this.meterSlots) this.publishMeterFrame();
+
     // call me again when the next block of samples is needed
     return true;
   }
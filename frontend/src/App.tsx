@@ -1,5 +1,6 @@
 import { useState, useRef } from "react";
 import "./App.css";
+import Meters from "./Meters";
 
 function App() {
   const [inLoop, setInLoop] = useState(false);
@@ -7,6 +8,7 @@ function App() {
   const [ottAmount, setOttAmount] = useState(0);
   const [distortionAmount, setDistortionAmount] = useState(0);
   const [reverbAmount, setReverbAmount] = useState(0.3);
+  const [meterBuffer, setMeterBuffer] = useState<SharedArrayBuffer | null>(null);
   const audioContextRef = useRef<AudioContext | null>(null);
   const workletNodeRef = useRef<AudioWorkletNode | null>(null);
 
@@ -28,6 +30,8 @@ function App() {
 
     node.port.onmessage = async (e) => {
       if (e.data.type === "ready") {
+        // null when the page isn't cross-origin isolated
+        setMeterBuffer(e.data.meterBuffer);
         await loadIR();
         await loadSample();
         setPlaybackReady(true);
@@ -163,6 +167,7 @@ function App() {
           onChange={handleReverbAmount}
         />
       </div>
+      {meterBuffer && <Meters buffer={meterBuffer} />}
     </div>
   );
 }
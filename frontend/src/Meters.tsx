@@ -0,0 +1,83 @@
+import { useEffect, useRef } from "react";
+import {
+  MeterReader,
+  NUM_OTT_BANDS,
+  NUM_SPECTRUM_BANDS,
+  STAGE_NAMES,
+} from "./meterFrame";
+
+const WIDTH = 480;
+const HEIGHT = 240;
+const MIN_DB = -60;
+
+const toDb = (linear: number) => 20 * Math.log10(Math.max(linear, 1e-6));
+
+// 0 at MIN_DB, 1 at 0 dB
+const dbToUnit = (db: number) =>
+  Math.min(Math.max((db - MIN_DB) / -MIN_DB, 0), 1);
+
+// Draws engine-side meters straight onto a canvas each animation frame, so the
+// display never goes through React state or worklet messages.
+function Meters({ buffer }: { buffer: SharedArrayBuffer }) {
+  const canvasRef = useRef<HTMLCanvasElement | null>(null);
+
+  useEffect(() => {
+    const ctx = canvasRef.current?.getContext("2d");
+    if (!ctx) return;
+
+    const reader = new MeterReader(buffer);
+    let rafId = 0;
+
+    const draw = () => {
+      const frame = reader.read();
+      ctx.clearRect(0, 0, WIDTH, HEIGHT);
+      ctx.font = "10px sans-serif";
+
+      // stage levels: RMS bar with a peak tick, left and right
+      const barWidth = 14;
+      frame.levels.forEach((level, s) => {
+        const x = 10 + s * 50;
+        for (let ch = 0; ch < 2; ch++) {
+          const rms = dbToUnit(toDb(level[2 + ch])) * 100;
+          const peak = dbToUnit(toDb(level[ch])) * 100;
+          const bx = x + ch * (barWidth + 2);
+          ctx.fillStyle = "#4caf50";
+          ctx.fillRect(bx, 110 - rms, barWidth, rms);
+          ctx.fillStyle = "#ffeb3b";
+          ctx.fillRect(bx, 110 - peak, barWidth, 2);
+        }
+        ctx.fillStyle = "#888";
+        ctx.fillText(STAGE_NAMES[s], x, 122);
+      });
+
+      // OTT gain reduction per band, drawn downward from the top
+      for (let b = 0; b < NUM_OTT_BANDS; b++) {
+        const reduction = dbToUnit(MIN_DB - frame.ottGainReductionDb[b]) * 100;
+        ctx.fillStyle = "#f44336";
+        ctx.fillRect(220 + b * 20, 10, 14, reduction);
+      }
+      ctx.fillStyle = "#888";
+      ctx.fillText("OTT GR", 220, 122);
+
+      // post-reverb spectrum
+      ctx.strokeStyle = "#61dafb";
+      ctx.beginPath();
+      for (let b = 0; b < NUM_SPECTRUM_BANDS; b++) {
+        const x = (b / (NUM_SPECTRUM_BANDS - 1)) * WIDTH;
+        const y = HEIGHT - dbToUnit(frame.spectrumDb[b]) * 100;
+        if (b === 0) ctx.moveTo(x, y);
+        else ctx.lineTo(x, y);
+      }
+      ctx.stroke();
+
+      rafId = requestAnimationFrame(draw);
+    };
+
+    rafId = requestAnimationFrame(draw);
+    return () => cancelAnimationFrame(rafId);
+  }, [buffer]);
+
+  return <canvas ref={canvasRef} width={WIDTH} height={HEIGHT} />;
+}
+
+export default Meters;
@@ -0,0 +1,52 @@
+// Mirrors MeterFrame in dsp/meter.h
+export const NUM_STAGES = 4;
+export const NUM_OTT_BANDS = 3;
+export const NUM_SPECTRUM_BANDS = 64;
+
+export const STAGE_NAMES = ["Pre-dist", "Post-dist", "Post-OTT", "Post-reverb"];
+
+const LEVELS_OFFSET = 0;
+const OTT_OFFSET = LEVELS_OFFSET + NUM_STAGES * 4;
+const SPECTRUM_OFFSET = OTT_OFFSET + NUM_OTT_BANDS;
+const FRAME_SIZE = SPECTRUM_OFFSET + NUM_SPECTRUM_BANDS;
+
+const FRESH = 4;
+const INDEX_MASK = 3;
+
+export interface MeterFrame {
+  // [peakL, peakR, rmsL, rmsR] per stage, linear
+  levels: Float32Array[];
+  ottGainReductionDb: Float32Array;
+  spectrumDb: Float32Array;
+}
+
+// Reader side of the triple buffer written by dsp-processor.js. read() never
+// blocks or allocates; it returns the newest complete frame.
+export class MeterReader {
+  private state: Int32Array;
+  private frames: MeterFrame[];
+  private front = 2;
+
+  constructor(buffer: SharedArrayBuffer) {
+    this.state = new Int32Array(buffer, 0, 1);
+    this.frames = [0, 1, 2].map((slot) => {
+      const base = 4 + slot * FRAME_SIZE;
+      const view = (offset: number, length: number) =>
+        new Float32Array(buffer, (base + offset) * 4, length);
+      return {
+        levels: Array.from({ length: NUM_STAGES }, (_, s) =>
+          view(LEVELS_OFFSET + s * 4, 4),
+        ),
+        ottGainReductionDb: view(OTT_OFFSET, NUM_OTT_BANDS),
+        spectrumDb: view(SPECTRUM_OFFSET, NUM_SPECTRUM_BANDS),
+      };
+    });
+  }
+
+  read(): MeterFrame {
+    if (Atomics.load(this.state, 0) & FRESH) {
+      this.front = Atomics.exchange(this.state, 0, this.front) & INDEX_MASK;
+    }
+    return this.frames[this.front];
+  }
+}
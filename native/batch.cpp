@@ -0,0 +1,153 @@
+#include "batch.h"
+
+#include "../dsp/sampler.h"
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+// --- Sinks ---
+
+void BufferSink::write(const float* left, const float* right, int numSamples)
+{
+  this->left.insert(this->left.end(), left, left + numSamples);
+  this->right.insert(this->right.end(), right, right + numSamples);
+}
+
+WavFileSink::WavFileSink(const std::string& path, int sampleRate)
+  : writer_(path, sampleRate)
+  , path_(path)
+{
+  if (!writer_.isOpen() || writer_.hasFailed())
+    throw std::runtime_error("could not open " + path + " for writing");
+}
+
+void WavFileSink::write(const float* left, const float* right, int numSamples)
+{
+  if (!writer_.write(left, right, numSamples))
+    throw std::runtime_error("could not write " + path_);
+}
+
+void WavFileSink::finish()
+{
+  if (!writer_.close())
+    throw std::runtime_error("could not finish " + path_);
+}
+
+// --- BatchRenderer ---
+
+BatchRenderer::BatchRenderer(float sampleRate, int numWorkers)
+  : sampleRate_(sampleRate)
+  , pool_(numWorkers > 0
+            ? numWorkers
+            : static_cast<int>(std::max(1u, std::thread::hardware_concurrency())))
+{
+  for (int i = 0; i < pool_.getNumWorkers(); ++i) {
+    auto engine = std::make_unique<Sampler>();
+    engine->prepare(sampleRate_);
+    engine->setRenderCache(true);
+    engines_.push_back(std::move(engine));
+  }
+}
+
+BatchRenderer::~BatchRenderer() = default;
+
+void BatchRenderer::render(const std::vector<RenderJob>& jobs)
+{
+  // Reject the whole batch up front rather than failing on a worker halfway
+  for (size_t i = 0; i < jobs.size(); ++i) {
+    const RenderJob& job = jobs[i];
+    std::string prefix = "render job " + std::to_string(i) + ": ";
+
+    if (job.impulseResponse && job.impulseResponse->numChannels != 1 &&
+        job.impulseResponse->numChannels != 2)
+      throw std::invalid_argument(prefix +
+                                  "impulse response must be mono or stereo");
+
+    // Sampler::setBpm() would clamp these silently
+    if (!(job.bpm >= Sampler::minBpm && job.bpm <= Sampler::maxBpm)) {
+      int minBpm = static_cast<int>(Sampler::minBpm);
+      int maxBpm = static_cast<int>(Sampler::maxBpm);
+      throw std::invalid_argument(prefix + "bpm must be between " +
+                                  std::to_string(minBpm) + " and " +
+                                  std::to_string(maxBpm));
+    }
+  }
+
+  // Partition each distinct IR once, in parallel, before any job needs it
+  std::map<const AudioClip*, StereoPartitionedIR> irs;
+  for (const auto& job : jobs) {
+    if (job.impulseResponse)
+      irs.try_emplace(job.impulseResponse.get());
+  }
+
+  for (auto& [clip, ir] : irs) {
+    pool_.submit([clip, &ir](int) {
+      size_t length = clip->samples.size() / clip->numChannels;
+      ir = StereoConvolutionReverb::partitionIR(
+        clip->samples.data(), length, clip->numChannels);
+    });
+  }
+  pool_.wait();
+
+  static const StereoPartitionedIR noIR;
+
+  for (const auto& job : jobs) {
+    const StereoPartitionedIR* ir =
+      job.impulseResponse ? &irs.at(job.impulseResponse.get()) : &noIR;
+
+    pool_.submit([this, &job, ir](int worker) {
+      renderJob(job, *ir, *engines_[worker]);
+    });
+  }
+  pool_.wait();
+}
+
+void BatchRenderer::renderJob(const RenderJob& job,
+                              const StereoPartitionedIR& ir,
+                              Sampler& engine)
+{
+  // prepare() clears playback, filter, envelope and reverb state left over
+  // from the engine's previous job
+  engine.prepare(sampleRate_);
+  engine.setBpm(job.bpm);
+  engine.setImpulseResponse(ir);
+  engine.setWaveshaperDrive(job.drive);
+  engine.setOTTAmount(job.ottAmount);
+  engine.setReverbMix(job.reverbMix, 1.0f - job.reverbMix);
+
+  if (job.sample)
+    engine.loadSample(reinterpret_cast<uintptr_t>(job.sample->data()),
+                      job.sample->size());
+  else
+    engine.loadSample(0, 0);
+
+  if (job.loop) {
+    engine.setLooping(true);
+  } else {
+    engine.setLooping(false);
+    engine.trigger();
+  }
+
+  float left[blockSize_];
+  float right[blockSize_];
+  size_t remaining = job.lengthSamples;
+
+  while (remaining > 0) {
+    int numSamples =
+      static_cast<int>(std::min(remaining, static_cast<size_t>(blockSize_)));
+    engine.process(reinterpret_cast<uintptr_t>(left),
+                   reinterpret_cast<uintptr_t>(right),
+                   numSamples);
+
+    if (job.output)
+      job.output->write(left, right, numSamples);
+
+    remaining -= static_cast<size_t>(numSamples);
+  }
+
+  if (job.output)
+    job.output->finish();
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "threadpool.h"
+#include "wav.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class Sampler;
+struct StereoPartitionedIR;
+
+// Interleaved audio. Jobs that point at the same impulse response clip share
+// one set of FFT'd partitions.
+struct AudioClip
+{
+  std::vector<float> samples;
+  int numChannels = 1;
+};
+
+// Receives a job's output block by block, on the worker rendering it.
+class RenderSink
+{
+public:
+  virtual ~RenderSink() = default;
+  virtual void write(const float* left, const float* right, int numSamples) = 0;
+  virtual void finish() {}
+};
+
+class BufferSink : public RenderSink
+{
+public:
+  void write(const float* left, const float* right, int numSamples) override;
+
+  std::vector<float> left;
+  std::vector<float> right;
+};
+
+class WavFileSink : public RenderSink
+{
+public:
+  // All three throw std::runtime_error if the file can't be created or
+  // written; a file that failed part way is left with an empty data chunk
+  WavFileSink(const std::string& path, int sampleRate);
+
+  void write(const float* left, const float* right, int numSamples) override;
+  void finish() override;
+
+private:
+  WavFileWriter writer_;
+  std::string path_;
+};
+
+struct RenderJob
+{
+  std::shared_ptr<const std::vector<float>> sample; // mono
+  std::shared_ptr<const AudioClip> impulseResponse; // mono or stereo; optional
+  float drive = 6.0f;
+  float ottAmount = 0.0f;
+  float reverbMix = 0.3f; // wet level; dry is 1 - wet, as in the UI
+  float bpm = 140.0f;
+  bool loop = true;
+  size_t lengthSamples = 0;
+  std::shared_ptr<RenderSink> output;
+};
+
+// Renders independent jobs through Sampler on a work-stealing pool. Each
+// worker owns one engine that is re-prepared for every job it picks up, and
+// each distinct impulse response is partitioned once per render() call.
+class BatchRenderer
+{
+public:
+  explicit BatchRenderer(float sampleRate, int numWorkers = 0);
+  ~BatchRenderer();
+
+  int getNumWorkers() const { return pool_.getNumWorkers(); }
+
+  // Throws std::invalid_argument, before rendering anything, if a job's
+  // impulse response is not mono or stereo or its bpm is outside
+  // Sampler::minBpm .. Sampler::maxBpm. If partitioning an IR, rendering a
+  // job or a sink throws, the rest of the batch still runs and the first
+  // such exception is rethrown once it has finished.
+  void render(const std::vector<RenderJob>& jobs);
+
+private:
+  void renderJob(const RenderJob& job, const StereoPartitionedIR& ir,
+                 Sampler& engine);
+
+  static constexpr int blockSize_ = 128;
+
+  float sampleRate_;
+
+  // Declared before pool_ so the workers are joined before engines go away
+  std::vector<std::unique_ptr<Sampler>> engines_;
+  WorkStealingPool pool_;
+};
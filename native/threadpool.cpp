@@ -0,0 +1,116 @@
+#include "threadpool.h"
+
+#include <algorithm>
+#include <utility>
+
+WorkStealingPool::WorkStealingPool(int numWorkers)
+{
+  numWorkers = std::max(numWorkers, 1);
+
+  for (int i = 0; i < numWorkers; ++i)
+    queues_.push_back(std::make_unique<Queue>());
+
+  for (int i = 0; i < numWorkers; ++i)
+    threads_.emplace_back([this, i] { workerLoop(i); });
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    stopping_ = true;
+  }
+  workAvailable_.notify_all();
+
+  for (auto& thread : threads_)
+    thread.join();
+}
+
+void WorkStealingPool::submit(Task task)
+{
+  // Count the task before it becomes visible; otherwise a worker could pop
+  // and finish it first, underflowing the counters and waking wait() early.
+  // A worker that sees queued_ > 0 ahead of the push just retries tryPop().
+  size_t index;
+  {
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    index = nextQueue_++ % queues_.size();
+    ++queued_;
+    ++pending_;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    queues_[index]->tasks.push_back(std::move(task));
+  }
+  workAvailable_.notify_one();
+}
+
+void WorkStealingPool::wait()
+{
+  std::unique_lock<std::mutex> lock(stateMutex_);
+  allDone_.wait(lock, [this] { return pending_ == 0; });
+
+  if (error_)
+    std::rethrow_exception(std::exchange(error_, nullptr));
+}
+
+bool WorkStealingPool::tryPop(int worker, Task& task)
+{
+  {
+    Queue& own = *queues_[worker];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      return true;
+    }
+  }
+
+  size_t numQueues = queues_.size();
+  for (size_t offset = 1; offset < numQueues; ++offset) {
+    Queue& victim = *queues_[(worker + offset) % numQueues];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void WorkStealingPool::workerLoop(int worker)
+{
+  while (true) {
+    Task task;
+    if (tryPop(worker, task)) {
+      {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        --queued_;
+      }
+
+      // An escaping exception would terminate the process; keep the first
+      // one for wait() and let the remaining tasks run
+      std::exception_ptr error;
+      try {
+        task(worker);
+      } catch (...) {
+        error = std::current_exception();
+      }
+
+      std::lock_guard<std::mutex> lock(stateMutex_);
+      if (error && !error_)
+        error_ = error;
+      if (--pending_ == 0)
+        allDone_.notify_all();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    workAvailable_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+    if (stopping_ && queued_ == 0)
+      return;
+  }
+}
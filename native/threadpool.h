@@ -0,0 +1,52 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of workers, each with its own task deque. A worker pops from the
+// back of its own deque and, when that is empty, steals from the front of
+// the others, so uneven jobs still keep every core busy. Tasks receive the
+// index of the worker running them, for per-worker state.
+class WorkStealingPool
+{
+public:
+  using Task = std::function<void(int worker)>;
+
+  explicit WorkStealingPool(int numWorkers);
+  ~WorkStealingPool();
+
+  int getNumWorkers() const { return static_cast<int>(threads_.size()); }
+
+  void submit(Task task);
+  // Blocks until every submitted task has run, then rethrows the first
+  // exception a task threw since the last wait(), if any
+  void wait();
+
+private:
+  struct Queue
+  {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  bool tryPop(int worker, Task& task);
+  void workerLoop(int worker);
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> threads_;
+
+  std::mutex stateMutex_;
+  std::condition_variable workAvailable_;
+  std::condition_variable allDone_;
+  size_t queued_ = 0;
+  size_t pending_ = 0;
+  size_t nextQueue_ = 0;
+  bool stopping_ = false;
+  std::exception_ptr error_;
+};
@@ -0,0 +1,111 @@
+#include "wav.h"
+
+#include <algorithm>
+
+namespace {
+
+constexpr uint16_t numChannels = 2;
+constexpr uint16_t bytesPerSample = 4;
+constexpr uint16_t formatIEEEFloat = 3;
+
+void writeU32(std::ofstream& file, uint32_t value)
+{
+  char bytes[4] = { static_cast<char>(value & 0xff),
+                    static_cast<char>((value >> 8) & 0xff),
+                    static_cast<char>((value >> 16) & 0xff),
+                    static_cast<char>((value >> 24) & 0xff) };
+  file.write(bytes, 4);
+}
+
+void writeU16(std::ofstream& file, uint16_t value)
+{
+  char bytes[2] = { static_cast<char>(value & 0xff),
+                    static_cast<char>((value >> 8) & 0xff) };
+  file.write(bytes, 2);
+}
+
+} // namespace
+
+WavFileWriter::WavFileWriter(const std::string& path, int sampleRate)
+  : file_(path, std::ios::binary)
+  , sampleRate_(sampleRate)
+{
+  if (file_.is_open()) {
+    writeHeader();
+    failed_ = file_.fail();
+  }
+}
+
+WavFileWriter::~WavFileWriter()
+{
+  close();
+}
+
+bool WavFileWriter::write(const float* left, const float* right,
+                          int numSamples)
+{
+  if (!file_.is_open() || failed_)
+    return false;
+
+  float interleaved[256];
+  int written = 0;
+
+  while (written < numSamples) {
+    int chunk = std::min(numSamples - written, 128);
+    for (int i = 0; i < chunk; ++i) {
+      interleaved[i * 2] = left[written + i];
+      interleaved[i * 2 + 1] = right[written + i];
+    }
+    file_.write(reinterpret_cast<const char*>(interleaved),
+                chunk * numChannels * bytesPerSample);
+    if (file_.fail()) {
+      failed_ = true;
+      return false;
+    }
+    written += chunk;
+  }
+
+  numFrames_ += static_cast<uint32_t>(numSamples);
+  return true;
+}
+
+bool WavFileWriter::close()
+{
+  if (!file_.is_open())
+    return !failed_;
+
+  if (!failed_) {
+    file_.seekp(0);
+    writeHeader();
+    file_.flush();
+    failed_ = file_.fail();
+  }
+
+  file_.close();
+  if (file_.fail())
+    failed_ = true;
+
+  return !failed_;
+}
+
+void WavFileWriter::writeHeader()
+{
+  uint32_t dataBytes = numFrames_ * numChannels * bytesPerSample;
+
+  file_.write("RIFF", 4);
+  writeU32(file_, 36 + dataBytes);
+  file_.write("WAVE", 4);
+
+  file_.write("fmt ", 4);
+  writeU32(file_, 16);
+  writeU16(file_, formatIEEEFloat);
+  writeU16(file_, numChannels);
+  writeU32(file_, static_cast<uint32_t>(sampleRate_));
+  writeU32(file_, static_cast<uint32_t>(sampleRate_) * numChannels *
+                    bytesPerSample);
+  writeU16(file_, numChannels * bytesPerSample);
+  writeU16(file_, bytesPerSample * 8);
+
+  file_.write("data", 4);
+  writeU32(file_, dataBytes);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+// Streams stereo 32-bit float samples to a WAV file. The header's sizes are
+// patched in close(), so nothing is buffered beyond the ofstream. If any
+// write fails (full disk, I/O error) the writer stops, and close() leaves the
+// header claiming no data rather than patching in a length it never wrote.
+class WavFileWriter
+{
+public:
+  WavFileWriter(const std::string& path, int sampleRate);
+  ~WavFileWriter();
+
+  bool isOpen() const { return file_.is_open(); }
+  bool hasFailed() const { return failed_; }
+
+  // Both return false once a write has failed
+  bool write(const float* left, const float* right, int numSamples);
+  bool close();
+
+private:
+  void writeHeader();
+
+  std::ofstream file_;
+  int sampleRate_;
+  bool failed_ = false;
+  uint32_t numFrames_ = 0;
+};